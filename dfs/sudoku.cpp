@@ -21,6 +21,11 @@
 #include <array>
 #include <string>
 #include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
 
 template<int B = 3>
 struct Sudoku {
@@ -28,31 +33,81 @@ struct Sudoku {
     constexpr static char EMPTYC = '_';
     static_assert(B > 0, "block size must be positive");
     static_assert(EMPTY == 0 || EMPTY > N, "default value for empty cells must be positive and must not overlap with valid values");
+    // 1マスあたりのビット数: B≤3なら4ビット(ニブル), N<256なら8ビット, それ以外は16ビット
+    constexpr static int CELL_BITS = (B <= 3 && EMPTY < 16) ? 4 : (N < 256 && EMPTY < 256) ? 8 : 16;
+    using cell_word_type = std::conditional_t<CELL_BITS == 16, std::uint16_t, std::uint8_t>;
+    constexpr static int CELLS_PER_WORD = static_cast<int>(sizeof(cell_word_type)) * 8 / CELL_BITS;
+    static_assert(N < (1 << CELL_BITS) && EMPTY < (1 << CELL_BITS), "cell values must fit in a packed cell");
     using field_array_type = std::array< std::array<int, N>, N>;
     static std::string output_space, output_line_break;
     static bool integral_input;
     static int input_empty_int;
     static char input_empty_char;
 private:
-    struct SudokuField : field_array_type {
-        SudokuField() noexcept : field_array_type() {}
-        SudokuField(field_array_type f, int empty_num = EMPTY) noexcept : field_array_type(f) {
-            if (empty_num != EMPTY) for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) if ((*this)[i][j] == empty_num) (*this)[i][j] = EMPTY;
+    constexpr static cell_word_type CELL_MASK = static_cast<cell_word_type>((1u << CELL_BITS) - 1);
+    constexpr static int words_for(int cells) noexcept {
+        return (cells + CELLS_PER_WORD - 1) / CELLS_PER_WORD;
+    }
+    constexpr static int get_cell(const cell_word_type* w, int k) noexcept {
+        return (w[k / CELLS_PER_WORD] >> (k % CELLS_PER_WORD * CELL_BITS)) & CELL_MASK;
+    }
+    constexpr static void set_cell(cell_word_type* w, int k, int v) noexcept {
+        int shift = k % CELLS_PER_WORD * CELL_BITS;
+        cell_word_type& t = w[k / CELLS_PER_WORD];
+        t = static_cast<cell_word_type>((t & ~(CELL_MASK << shift)) | (static_cast<cell_word_type>(v) << shift));
+    }
+    // 範囲外の値は詰めると別の値に化けるので, 詰める前に弾く
+    static int checked_cell(int v) {
+        if (v != EMPTY && (v < 1 || v > N)) throw std::out_of_range("Sudoku: cell value out of range");
+        return v;
+    }
+    // 盤面はマスをCELL_BITSビットずつ詰めて保持する
+    struct SudokuField {
+    private:
+        std::array<cell_word_type, words_for(N * N)> cells_;
+    public:
+        // field[i][j]で読み出すための行
+        struct Row {
+            const SudokuField* field;
+            int i;
+            constexpr int operator[](int j) const noexcept {
+                return field->at(i, j);
+            }
+        };
+        SudokuField() noexcept : cells_() {
+            if (EMPTY != 0) for (int k = 0; k < N * N; ++k) set_cell(cells_.data(), k, EMPTY);
+        }
+        SudokuField(const field_array_type& f, int empty_num = EMPTY) : SudokuField() {
+            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) set(i, j, checked_cell(f[i][j] == empty_num ? EMPTY : f[i][j]));
         }
         SudokuField(const std::vector< std::vector<int> >& v, int empty_num = EMPTY) : SudokuField() {
-            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) (*this)[i][j] = (v[i][j] == empty_num ? EMPTY : v[i][j]);
+            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) set(i, j, checked_cell(v[i][j] == empty_num ? EMPTY : v[i][j]));
         }
         SudokuField(const std::vector< std::vector<char> >& v, char empty_char = EMPTYC) : SudokuField() {
-            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) (*this)[i][j] = (v[i][j] == empty_char ? EMPTY : v[i][j] - '0');
+            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) set(i, j, checked_cell(v[i][j] == empty_char ? EMPTY : v[i][j] - '0'));
         }
         SudokuField(const std::vector<std::string>& v, char empty_char = EMPTYC) : SudokuField() {
-            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) (*this)[i][j] = (v[i][j] == empty_char ? EMPTY : v[i][j] - '0');
+            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) set(i, j, checked_cell(v[i][j] == empty_char ? EMPTY : v[i][j] - '0'));
+        }
+        constexpr int at(int i, int j) const noexcept {
+            return get_cell(cells_.data(), i * N + j);
+        }
+        constexpr void set(int i, int j, int v) noexcept {
+            set_cell(cells_.data(), i * N + j, v);
+        }
+        constexpr Row operator[](int i) const noexcept {
+            return {this, i};
+        }
+        field_array_type to_array() const noexcept {
+            field_array_type t;
+            for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) t[i][j] = at(i, j);
+            return t;
         }
         friend std::istream& operator>>(std::istream& s, SudokuField& a) {
             if (integral_input) {
                 field_array_type t;
                 for (auto&& i : t) for (auto&& j : i) s >> j;
-                a = SudokuField(std::move(t), input_empty_int);
+                a = SudokuField(t, input_empty_int);
             } else {
                 std::vector<std::string> t(N);
                 for (auto&& i : t) s >> i;
@@ -61,45 +116,120 @@ private:
             return s;
         }
         friend std::ostream& operator<<(std::ostream& s, const SudokuField& a) {
-            for (const auto& i : a) {
-                for (const auto& j : i) s << j << output_space;
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j) s << a.at(i, j) << output_space;
                 s << output_line_break;
             }
             return s;
         }
     };
     using field_type = SudokuField;
+    // 解は問題の空きマス(行優先順)に入る値だけを詰めて保持し, 参照時に盤面へ復元する
+    struct SolutionStore {
+    private:
+        field_type givens_;
+        std::vector<int> blanks_;
+        std::vector<cell_word_type> data_;
+        int stride_ = 0;
+        std::size_t count_ = 0;
+        friend struct Sudoku;
+        void reset(const field_type& givens) {
+            givens_ = givens;
+            blanks_.clear();
+            for (int k = 0; k < N * N; ++k) if (givens.at(k / N, k % N) == EMPTY) blanks_.push_back(k);
+            data_.clear();
+            stride_ = words_for(blanks_.size());
+            count_ = 0;
+        }
+        void push_back(const field_type& f) {
+            ++count_;
+            data_.resize(data_.size() + stride_);
+            cell_word_type* w = data_.data() + data_.size() - stride_;
+            for (int d = 0; d < static_cast<int>(blanks_.size()); ++d) set_cell(w, d, f.at(blanks_[d] / N, blanks_[d] % N));
+        }
+    public:
+        // 解を1つずつ盤面に復元しながら辿る
+        struct const_iterator {
+            using iterator_category = std::input_iterator_tag;
+            using value_type = field_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = field_type;
+            const SolutionStore* store;
+            std::size_t idx;
+            field_type operator*() const {
+                return (*store)[idx];
+            }
+            const_iterator& operator++() noexcept {
+                ++idx;
+                return *this;
+            }
+            const_iterator operator++(int) noexcept {
+                const_iterator t(*this);
+                ++idx;
+                return t;
+            }
+            bool operator==(const const_iterator& a) const noexcept {
+                return store == a.store && idx == a.idx;
+            }
+            bool operator!=(const const_iterator& a) const noexcept {
+                return !(*this == a);
+            }
+        };
+        const_iterator begin() const noexcept {
+            return {this, 0};
+        }
+        const_iterator end() const noexcept {
+            return {this, count_};
+        }
+        std::size_t size() const noexcept {
+            return count_;
+        }
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+        field_type operator[](std::size_t idx) const {
+            field_type t = givens_;
+            const cell_word_type* w = data_.data() + idx * stride_;
+            for (int d = 0; d < static_cast<int>(blanks_.size()); ++d) t.set(blanks_[d] / N, blanks_[d] % N, get_cell(w, d));
+            return t;
+        }
+        void clear() noexcept {
+            data_.clear();
+            count_ = 0;
+        }
+    };
     field_type field_;
     bool solved;
-    std::vector<field_type> solutions_;
-    constexpr std::optional< std::pair<int, int> > find_empty() const noexcept {
-        for (int i = 0; i < N; ++i) for (int j = 0; j < N; ++j) if (field_[i][j] == EMPTY) return {{i, j}};
-        return {};
-    }
-    void solve() {
-        auto empty_cell = find_empty();
-        if (!empty_cell.has_value()) {
+    SolutionStore solutions_;
+    void solve(int depth) {
+        const auto& blanks = solutions_.blanks_;
+        if (depth == static_cast<int>(blanks.size())) {
             solutions_.push_back(field_);
             return;
         }
-        auto [emptyy, emptyx] = empty_cell.value();
+        int emptyy = blanks[depth] / N, emptyx = blanks[depth] % N;
 
         std::bitset<N + 1> unavailable = 0;
-        for (int i = 0; i < N; ++i) unavailable.set(field_[emptyy][i]).set(field_[i][emptyx]);
-        for (int blocky = emptyy / B * B, blockx = emptyx / B * B, y = blocky; y < blocky + B; ++y) for (int x = blockx; x < blockx + B; ++x) unavailable.set(field_[y][x]);
+        for (int i = 0; i < N; ++i) unavailable.set(field_.at(emptyy, i)).set(field_.at(i, emptyx));
+        for (int blocky = emptyy / B * B, blockx = emptyx / B * B, y = blocky; y < blocky + B; ++y) for (int x = blockx; x < blockx + B; ++x) unavailable.set(field_.at(y, x));
 
         for (int v = 1; v <= N; ++v) {
             if (unavailable.test(v)) continue;
-            field_[emptyy][emptyx] = v;
-            solve();
+            field_.set(emptyy, emptyx, v);
+            solve(depth + 1);
         }
 
-        field_[emptyy][emptyx] = EMPTY;
+        field_.set(emptyy, emptyx, EMPTY);
+    }
+    void solve() {
+        solutions_.reset(field_);
+        solve(0);
     }
 public:
     template<typename... Args>
     Sudoku(Args... args) : field_(std::forward<Args>(args)...), solved(false), solutions_() {}
-    const std::vector<field_type>& solutions() {
+    const SolutionStore& solutions() {
         if (!solved) solve();
         solved = true;
         return solutions_;
@@ -64,6 +64,140 @@ value_type multiple_knapsack(int capacity, const vector< Item<weight_type, value
     return dp.at(capacity);
 }
 
+// 品物の追加・削除に対応したナップサック
+// 品物を積み上げた順にDPを積み上げ, 末尾の品物の削除はDPを1段戻すだけで済ませる
+// push: O(W), pop: O(1), query: O(1), メモリ: O(n * W)
+template<typename weight_type, typename value_type>
+struct KnapsackStack {
+    using item_type = Item<weight_type, value_type>;
+private:
+    int capacity_;
+    vector<item_type> items_;
+    // dp_.at(k).at(j) := 先頭k個の品物から重さの総和がj以下となるように選んだときの価値の総和の最大値
+    vector< vector<value_type> > dp_;
+public:
+    KnapsackStack(int capacity) : capacity_(capacity), items_(), dp_(1, vector<value_type>(capacity + 1, 0)) {}
+    void push(const item_type& i) {
+        items_.push_back(i);
+        dp_.push_back(dp_.back());
+        const auto& prev = dp_.at(dp_.size() - 2);
+        auto& dp = dp_.back();
+        for (weight_type j = capacity_ - i.weight; j >= 0; --j) upd_max(dp.at(j + i.weight), prev.at(j) + i.value);
+    }
+    void pop() {
+        items_.pop_back();
+        dp_.pop_back();
+    }
+    const item_type& top() const {
+        return items_.back();
+    }
+    int size() const noexcept {
+        return items_.size();
+    }
+    bool empty() const noexcept {
+        return items_.empty();
+    }
+    int capacity() const noexcept {
+        return capacity_;
+    }
+    const vector<value_type>& table() const noexcept {
+        return dp_.back();
+    }
+    // 重さの総和がcapacity以下となるときの価値の総和の最大値
+    value_type query(int capacity) const {
+        return dp_.back().at(capacity);
+    }
+};
+
+// 先に追加した品物から削除するナップサック(2つのスタックによるキュー)
+// push: O(W), pop: 償却O(W), query: O(capacity)
+template<typename weight_type, typename value_type>
+struct KnapsackQueue {
+    using item_type = Item<weight_type, value_type>;
+private:
+    // front_は先頭の品物ほど上に積まれ, back_は後から追加した品物ほど上に積まれる
+    KnapsackStack<weight_type, value_type> front_, back_;
+    void transfer() {
+        vector<item_type> t;
+        t.reserve(back_.size());
+        for (; !back_.empty(); back_.pop()) t.push_back(back_.top());
+        for (const auto& i : t) front_.push(i);
+    }
+public:
+    KnapsackQueue(int capacity) : front_(capacity), back_(capacity) {}
+    void push(const item_type& i) {
+        back_.push(i);
+    }
+    void pop() {
+        if (front_.empty()) transfer();
+        front_.pop();
+    }
+    const item_type& front() {
+        if (front_.empty()) transfer();
+        return front_.top();
+    }
+    int size() const noexcept {
+        return front_.size() + back_.size();
+    }
+    bool empty() const noexcept {
+        return front_.empty() && back_.empty();
+    }
+    value_type query(int capacity) const {
+        const auto& f = front_.table();
+        const auto& b = back_.table();
+        value_type r = 0;
+        for (int j = 0; j <= capacity; ++j) upd_max(r, f.at(j) + b.at(capacity - j));
+        return r;
+    }
+};
+
+template<typename weight_type, typename value_type>
+struct KnapsackOperation {
+    enum Type { ADD, REMOVE, QUERY };
+    Type type;
+    // ADD: 追加する品物
+    Item<weight_type, value_type> item;
+    // REMOVE: 取り除く品物を追加したADD操作の添字
+    int target;
+    // QUERY: 容量
+    int capacity;
+};
+
+// オフライン動的ナップサック(時間軸上のセグメント木)
+// 品物を追加した操作からそれを削除する操作までの区間を時間軸上のセグメント木のO(log T)個のノードに載せ,
+// 根から葉へ向かってKnapsackStackに積み, 戻るときに取り除く
+// O(T * log(T) * W), 各質問はO(1)
+template<typename weight_type, typename value_type>
+vector<value_type> offline_dynamic_knapsack(int capacity, const vector< KnapsackOperation<weight_type, value_type> >& ops) {
+    using operation_type = KnapsackOperation<weight_type, value_type>;
+    int t = ops.size(), sz = 1;
+    while (sz < t) sz <<= 1;
+    vector<int> removed(t, t);
+    for (int i = 0; i < t; ++i) if (ops.at(i).type == operation_type::REMOVE) removed.at(ops.at(i).target) = i;
+    vector< vector<int> > seg(sz << 1);
+    for (int i = 0; i < t; ++i) if (ops.at(i).type == operation_type::ADD) {
+        for (int l = i + sz, r = removed.at(i) + sz; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) seg.at(l++).push_back(i);
+            if (r & 1) seg.at(--r).push_back(i);
+        }
+    }
+    vector<value_type> res;
+    KnapsackStack<weight_type, value_type> st(capacity);
+    auto dfs = [&](auto&& self, int k) -> void {
+        if (k - sz >= t) return;
+        for (const auto& i : seg.at(k)) st.push(ops.at(i).item);
+        if (k >= sz) {
+            if (ops.at(k - sz).type == operation_type::QUERY) res.push_back(st.query(ops.at(k - sz).capacity));
+        } else {
+            self(self, k << 1);
+            self(self, k << 1 | 1);
+        }
+        for (int i = seg.at(k).size(); i > 0; --i) st.pop();
+    };
+    if (t) dfs(dfs, 1);
+    return res;
+}
+
 int main() {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
@@ -74,5 +208,29 @@ int main() {
     cout << knapsack1(w, v) << '\n';
     cout << knapsack2(w, v) << '\n';
     cout << multiple_knapsack(w, v) << '\n';
+
+    KnapsackQueue<int, int> q(w);
+    for (const auto& i : v) q.push(i);
+    cout << q.query(w) << '\n';
+    // 先頭の品物を除いたもの
+    if (!q.empty()) {
+        q.pop();
+        vector< Item<int, int> > rest(v.begin() + 1, v.end());
+        cout << q.query(w) << ' ' << (q.query(w) == knapsack1(w, rest) ? "Yes" : "No") << '\n';
+    }
+
+    // 全品物を追加し, 先頭から順に取り除きながら容量wで質問する
+    using operation_type = KnapsackOperation<int, int>;
+    vector<operation_type> ops;
+    for (const auto& i : v) ops.push_back({operation_type::ADD, i, -1, 0});
+    ops.push_back({operation_type::QUERY, {}, -1, w});
+    for (int i = 0; i < n; ++i) {
+        ops.push_back({operation_type::REMOVE, {}, i, 0});
+        ops.push_back({operation_type::QUERY, {}, -1, w});
+    }
+    auto res = offline_dynamic_knapsack(w, ops);
+    bool ok = true;
+    for (int i = 0; i <= n; ++i) ok &= res.at(i) == knapsack1(w, vector< Item<int, int> >(v.begin() + i, v.end()));
+    cout << res.at(0) << ' ' << (ok ? "Yes" : "No") << '\n';
     return 0;
 }
@@ -18,6 +18,13 @@
 #include <algorithm>
 #include <vector>
 #include <string>
+#include <optional>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -106,6 +113,474 @@ cost_type elastic_matching(const vector< vector<cost_type> >& c) {
     return dp.at(m).at(n);
 }
 
+// アフィンギャップ付き配列アラインメント(Gotoh)
+// 長さkのギャップのスコアは -(gap_open + gap_extend * k)
+// ・gap_open≥0, gap_extend≥1
+// ・配列の文字はalphabetに含まれる(含まれない文字はencodeがout_of_rangeを投げる)
+struct AlignmentScoring {
+    string alphabet;
+    // substitution.at(a).at(b) := alphabetのa番目とb番目の文字を対応させたときのスコア
+    vector< vector<int> > substitution;
+    int gap_open, gap_extend;
+private:
+    vector<int> code_;
+public:
+    AlignmentScoring(const string& a, const vector< vector<int> >& sub, int go, int ge) : alphabet(a), substitution(sub), gap_open(go), gap_extend(ge), code_(256, -1) {
+        for (int i = 0; i < static_cast<int>(alphabet.size()); ++i) code_.at(static_cast<unsigned char>(alphabet.at(i))) = i;
+    }
+    AlignmentScoring(const string& a, int match, int mismatch, int go, int ge) : AlignmentScoring(a, vector< vector<int> >(a.size(), vector<int>(a.size(), mismatch)), go, ge) {
+        for (int i = 0; i < static_cast<int>(alphabet.size()); ++i) substitution.at(i).at(i) = match;
+    }
+    vector<int> encode(const string& s) const {
+        vector<int> r(s.size());
+        for (int i = 0; i < static_cast<int>(s.size()); ++i) {
+            r.at(i) = code_.at(static_cast<unsigned char>(s.at(i)));
+            if (r.at(i) < 0) throw out_of_range("AlignmentScoring: character not in alphabet");
+        }
+        return r;
+    }
+    int score(int a, int b) const {
+        return substitution.at(a).at(b);
+    }
+    long long gap(long long k) const {
+        return k ? -(gap_open + static_cast<long long>(gap_extend) * k) : 0;
+    }
+};
+
+// GLOBAL: 両配列の全体を対応させる
+// LOCAL: 両配列の部分列どうしを対応させる(Smith-Waterman)
+// SEMI_GLOBAL: queryの全体をtargetの部分列に対応させる
+enum class AlignmentMode { GLOBAL, LOCAL, SEMI_GLOBAL };
+
+struct AlignmentResult {
+    long long score;
+    // アラインメントの終端(0-indexed, 両端を含む), 空のときは-1
+    int query_end, target_end;
+    // traceback指定時のみ: M(対応), I(queryの文字とギャップ), D(targetの文字とギャップ)を連長圧縮したもの
+    string cigar;
+};
+
+// 列(targetの1文字)ごとに更新する O(|query| * |target|), メモリ O(|query|)
+// 同点のときはtarget_end, query_endの順に小さいものを返す
+// anchoredのときは両配列の先頭からアラインメントを始める(LOCAL, SEMI_GLOBALの始端を逆向きに求めるのに使う)
+AlignmentResult gotoh_align(const vector<int>& q, const vector<int>& t, const AlignmentScoring& sc, AlignmentMode mode, bool anchored = false) {
+    constexpr long long INF = 1LL << 60;
+    int n = q.size(), m = t.size();
+    long long open = sc.gap_open + sc.gap_extend, ext = sc.gap_extend;
+    bool local = mode == AlignmentMode::LOCAL && !anchored;
+    auto left = [&](int i) -> long long {
+        return local ? 0 : sc.gap(i);
+    };
+    auto top = [&](int j) -> long long {
+        return mode == AlignmentMode::GLOBAL || anchored ? sc.gap(j) : 0;
+    };
+    vector<long long> h(n + 1), e(n + 1, -INF);
+    for (int i = 0; i <= n; ++i) h.at(i) = left(i);
+    AlignmentResult res{mode == AlignmentMode::LOCAL ? 0 : -INF, -1, -1, ""};
+    if (mode == AlignmentMode::SEMI_GLOBAL) res = {h.at(n), n - 1, -1, ""};
+    for (int j = 1; j <= m; ++j) {
+        long long diag = h.at(0), f = -INF;
+        h.at(0) = top(j);
+        for (int i = 1; i <= n; ++i) {
+            upd_max(e.at(i) -= ext, h.at(i) - open);
+            upd_max(f -= ext, h.at(i - 1) - open);
+            long long c = max({diag + sc.score(q.at(i - 1), t.at(j - 1)), e.at(i), f});
+            if (local) upd_max(c, 0);
+            diag = h.at(i);
+            h.at(i) = c;
+            if (mode == AlignmentMode::LOCAL && c > res.score) res = {c, i - 1, j - 1, ""};
+        }
+        if (mode == AlignmentMode::SEMI_GLOBAL && h.at(n) > res.score) res = {h.at(n), n - 1, j - 1, ""};
+    }
+    if (mode == AlignmentMode::GLOBAL) res = {h.at(n), n - 1, m - 1, ""};
+    return res;
+}
+
+// Farrarのストライプ法
+// queryをLANES本の帯に分け, i = l * seg_len + k番目の文字をk番目のベクトルのl番目のレーンに置く
+// レーンの値は[LOWEST, HIGHEST]で扱い, 値域を超える恐れがあるときはnulloptを返す
+// 8, 16ビットは飽和演算を使い, 32ビットは飽和しない代わりに値域を±2^30に絞って-∞の番兵が桁あふれしないようにする
+#if defined(__SSE2__)
+struct Sse2Int16 {
+    using lane_type = int16_t;
+    using vector_type = __m128i;
+    constexpr static int LANES = 8;
+    constexpr static lane_type LOWEST = numeric_limits<lane_type>::min(), HIGHEST = numeric_limits<lane_type>::max();
+    constexpr static bool SATURATING = true;
+    static vector_type load(const lane_type* p) { return _mm_loadu_si128(reinterpret_cast<const vector_type*>(p)); }
+    static void store(lane_type* p, vector_type a) { _mm_storeu_si128(reinterpret_cast<vector_type*>(p), a); }
+    static vector_type set1(lane_type x) { return _mm_set1_epi16(x); }
+    static vector_type adds(vector_type a, vector_type b) { return _mm_adds_epi16(a, b); }
+    static vector_type subs(vector_type a, vector_type b) { return _mm_subs_epi16(a, b); }
+    static vector_type max(vector_type a, vector_type b) { return _mm_max_epi16(a, b); }
+    static vector_type min(vector_type a, vector_type b) { return _mm_min_epi16(a, b); }
+    static bool any_gt(vector_type a, vector_type b) { return _mm_movemask_epi8(_mm_cmpgt_epi16(a, b)); }
+    // 各レーンを1つ上にずらし, 0番目のレーンにxを入れる
+    static vector_type shift_in(vector_type a, lane_type x) { return _mm_insert_epi16(_mm_slli_si128(a, 2), x, 0); }
+};
+#endif
+#if defined(__SSE4_1__)
+struct Sse41Int8 {
+    using lane_type = int8_t;
+    using vector_type = __m128i;
+    constexpr static int LANES = 16;
+    constexpr static lane_type LOWEST = numeric_limits<lane_type>::min(), HIGHEST = numeric_limits<lane_type>::max();
+    constexpr static bool SATURATING = true;
+    static vector_type load(const lane_type* p) { return _mm_loadu_si128(reinterpret_cast<const vector_type*>(p)); }
+    static void store(lane_type* p, vector_type a) { _mm_storeu_si128(reinterpret_cast<vector_type*>(p), a); }
+    static vector_type set1(lane_type x) { return _mm_set1_epi8(x); }
+    static vector_type adds(vector_type a, vector_type b) { return _mm_adds_epi8(a, b); }
+    static vector_type subs(vector_type a, vector_type b) { return _mm_subs_epi8(a, b); }
+    static vector_type max(vector_type a, vector_type b) { return _mm_max_epi8(a, b); }
+    static vector_type min(vector_type a, vector_type b) { return _mm_min_epi8(a, b); }
+    static bool any_gt(vector_type a, vector_type b) { return _mm_movemask_epi8(_mm_cmpgt_epi8(a, b)); }
+    static vector_type shift_in(vector_type a, lane_type x) { return _mm_insert_epi8(_mm_slli_si128(a, 1), x, 0); }
+};
+struct Sse41Int32 {
+    using lane_type = int32_t;
+    using vector_type = __m128i;
+    constexpr static int LANES = 4;
+    constexpr static lane_type LOWEST = -(1 << 30), HIGHEST = 1 << 30;
+    constexpr static bool SATURATING = false;
+    static vector_type load(const lane_type* p) { return _mm_loadu_si128(reinterpret_cast<const vector_type*>(p)); }
+    static void store(lane_type* p, vector_type a) { _mm_storeu_si128(reinterpret_cast<vector_type*>(p), a); }
+    static vector_type set1(lane_type x) { return _mm_set1_epi32(x); }
+    static vector_type adds(vector_type a, vector_type b) { return _mm_add_epi32(a, b); }
+    static vector_type subs(vector_type a, vector_type b) { return _mm_sub_epi32(a, b); }
+    static vector_type max(vector_type a, vector_type b) { return _mm_max_epi32(a, b); }
+    static vector_type min(vector_type a, vector_type b) { return _mm_min_epi32(a, b); }
+    static bool any_gt(vector_type a, vector_type b) { return _mm_movemask_epi8(_mm_cmpgt_epi32(a, b)); }
+    static vector_type shift_in(vector_type a, lane_type x) { return _mm_insert_epi32(_mm_slli_si128(a, 4), x, 0); }
+};
+#endif
+#if defined(__AVX2__)
+struct Avx2Int16 {
+    using lane_type = int16_t;
+    using vector_type = __m256i;
+    constexpr static int LANES = 16;
+    constexpr static lane_type LOWEST = numeric_limits<lane_type>::min(), HIGHEST = numeric_limits<lane_type>::max();
+    constexpr static bool SATURATING = true;
+    static vector_type load(const lane_type* p) { return _mm256_loadu_si256(reinterpret_cast<const vector_type*>(p)); }
+    static void store(lane_type* p, vector_type a) { _mm256_storeu_si256(reinterpret_cast<vector_type*>(p), a); }
+    static vector_type set1(lane_type x) { return _mm256_set1_epi16(x); }
+    static vector_type adds(vector_type a, vector_type b) { return _mm256_adds_epi16(a, b); }
+    static vector_type subs(vector_type a, vector_type b) { return _mm256_subs_epi16(a, b); }
+    static vector_type max(vector_type a, vector_type b) { return _mm256_max_epi16(a, b); }
+    static vector_type min(vector_type a, vector_type b) { return _mm256_min_epi16(a, b); }
+    static bool any_gt(vector_type a, vector_type b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi16(a, b)); }
+    // 128ビットの境界をまたいでずらすため, 下半分を上半分へ移したものとつなげる
+    static vector_type shift_in(vector_type a, lane_type x) { return _mm256_insert_epi16(_mm256_alignr_epi8(a, _mm256_permute2x128_si256(a, a, 0x08), 14), x, 0); }
+};
+struct Avx2Int8 {
+    using lane_type = int8_t;
+    using vector_type = __m256i;
+    constexpr static int LANES = 32;
+    constexpr static lane_type LOWEST = numeric_limits<lane_type>::min(), HIGHEST = numeric_limits<lane_type>::max();
+    constexpr static bool SATURATING = true;
+    static vector_type load(const lane_type* p) { return _mm256_loadu_si256(reinterpret_cast<const vector_type*>(p)); }
+    static void store(lane_type* p, vector_type a) { _mm256_storeu_si256(reinterpret_cast<vector_type*>(p), a); }
+    static vector_type set1(lane_type x) { return _mm256_set1_epi8(x); }
+    static vector_type adds(vector_type a, vector_type b) { return _mm256_adds_epi8(a, b); }
+    static vector_type subs(vector_type a, vector_type b) { return _mm256_subs_epi8(a, b); }
+    static vector_type max(vector_type a, vector_type b) { return _mm256_max_epi8(a, b); }
+    static vector_type min(vector_type a, vector_type b) { return _mm256_min_epi8(a, b); }
+    static bool any_gt(vector_type a, vector_type b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi8(a, b)); }
+    static vector_type shift_in(vector_type a, lane_type x) { return _mm256_insert_epi8(_mm256_alignr_epi8(a, _mm256_permute2x128_si256(a, a, 0x08), 15), x, 0); }
+};
+struct Avx2Int32 {
+    using lane_type = int32_t;
+    using vector_type = __m256i;
+    constexpr static int LANES = 8;
+    constexpr static lane_type LOWEST = -(1 << 30), HIGHEST = 1 << 30;
+    constexpr static bool SATURATING = false;
+    static vector_type load(const lane_type* p) { return _mm256_loadu_si256(reinterpret_cast<const vector_type*>(p)); }
+    static void store(lane_type* p, vector_type a) { _mm256_storeu_si256(reinterpret_cast<vector_type*>(p), a); }
+    static vector_type set1(lane_type x) { return _mm256_set1_epi32(x); }
+    static vector_type adds(vector_type a, vector_type b) { return _mm256_add_epi32(a, b); }
+    static vector_type subs(vector_type a, vector_type b) { return _mm256_sub_epi32(a, b); }
+    static vector_type max(vector_type a, vector_type b) { return _mm256_max_epi32(a, b); }
+    static vector_type min(vector_type a, vector_type b) { return _mm256_min_epi32(a, b); }
+    static bool any_gt(vector_type a, vector_type b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi32(a, b)); }
+    static vector_type shift_in(vector_type a, lane_type x) { return _mm256_insert_epi32(_mm256_alignr_epi8(a, _mm256_permute2x128_si256(a, a, 0x08), 12), x, 0); }
+};
+#endif
+
+#if defined(__AVX2__)
+using AlignmentVector8 = Avx2Int8;
+using AlignmentVector16 = Avx2Int16;
+using AlignmentVector32 = Avx2Int32;
+#elif defined(__SSE4_1__)
+using AlignmentVector8 = Sse41Int8;
+using AlignmentVector16 = Sse2Int16;
+using AlignmentVector32 = Sse41Int32;
+#elif defined(__SSE2__)
+using AlignmentVector16 = Sse2Int16;
+#endif
+
+// 文字ごとにqueryをストライプ状に並べたスコア表
+template<typename V>
+struct StripedProfile {
+    using lane_type = typename V::lane_type;
+    int seg_len;
+    bool valid;
+    // data.at((a * seg_len + k) * LANES + l) := score(query[l * seg_len + k], a)
+    vector<lane_type> data;
+    StripedProfile() : seg_len(0), valid(false), data() {}
+    StripedProfile(const vector<int>& q, const AlignmentScoring& sc, AlignmentMode mode) : seg_len((q.size() + V::LANES - 1) / V::LANES), valid(true), data() {
+        constexpr int LO = V::LOWEST, HI = V::HIGHEST;
+        int n = q.size(), sigma = sc.alphabet.size();
+        data.assign(static_cast<size_t>(sigma) * seg_len * V::LANES, 0);
+        for (int a = 0; a < sigma; ++a) for (int k = 0; k < seg_len; ++k) for (int l = 0; l < V::LANES; ++l) {
+            int i = l * seg_len + k, s;
+            // 末尾の詰め物はLOCALでは最小値にして, 最大値の位置に現れないようにする
+            if (i < n) s = sc.score(q.at(i), a);
+            else s = mode == AlignmentMode::LOCAL ? LO : 0;
+            if (s < LO || s > HI) valid = false;
+            data.at((static_cast<size_t>(a) * seg_len + k) * V::LANES + l) = max(LO, min(HI, s));
+        }
+    }
+};
+
+// anchoredの意味はgotoh_alignと同じで, スコアがstop以上になった列で打ち切る(その列までの結果はgotoh_alignと一致する)
+template<typename V>
+optional<AlignmentResult> striped_align(const StripedProfile<V>& profile, int n, const vector<int>& t, const AlignmentScoring& sc, AlignmentMode mode, bool anchored = false, long long stop = numeric_limits<long long>::max()) {
+    using lane_type = typename V::lane_type;
+    using vector_type = typename V::vector_type;
+    constexpr int L = V::LANES;
+    constexpr long long LO = V::LOWEST, HI = V::HIGHEST;
+    if (!profile.valid) return {};
+    int m = t.size(), seg_len = profile.seg_len;
+    bool local = mode == AlignmentMode::LOCAL && !anchored;
+    long long open = sc.gap_open + sc.gap_extend, ext = sc.gap_extend, sub_lo = 0, sub_hi = 0;
+    for (const auto& i : sc.substitution) for (const auto& j : i) upd_min(sub_lo, j), upd_max(sub_hi, j);
+    // 途中の値がこの範囲に収まっていれば飽和は起きていない
+    long long lower = LO + open - sub_lo, upper = HI - sub_hi;
+    auto left = [&](int i) -> long long {
+        return local ? 0 : sc.gap(i);
+    };
+    auto top = [&](int j) -> long long {
+        return mode == AlignmentMode::GLOBAL || anchored ? sc.gap(j) : 0;
+    };
+    if (lower >= upper || left(seg_len * L) <= lower || top(m) <= lower) return {};
+    // 飽和しないレーンでは番兵から引くギャップ延長の総量(高々 列の長さ * LANES回)が余白に収まる必要がある
+    if (!V::SATURATING && (static_cast<long long>(seg_len) * L + 1) * ext >= HI) return {};
+
+    vector<lane_type> h_load(seg_len * L), h_store(seg_len * L), e(seg_len * L, LO), buf(L);
+    for (int k = 0; k < seg_len; ++k) for (int l = 0; l < L; ++l) h_load.at(k * L + l) = left(l * seg_len + k + 1);
+    const vector_type v_open = V::set1(open), v_ext = V::set1(ext), v_zero = V::set1(0), v_neg = V::set1(LO);
+    vector_type v_max = V::set1(local ? 0 : LO), v_min = V::set1(HI);
+    AlignmentResult res{mode == AlignmentMode::LOCAL ? 0 : -(1LL << 60), -1, -1, ""};
+    if (mode == AlignmentMode::SEMI_GLOBAL) res = {left(n), n - 1, -1, ""};
+    auto lane = [&](const vector<lane_type>& h, int i) -> long long {
+        return h.at(i % seg_len * L + i / seg_len);
+    };
+
+    for (int j = 0; j < m && res.score < stop; ++j) {
+        const lane_type* p = profile.data.data() + static_cast<size_t>(t.at(j)) * seg_len * L;
+        vector_type v_h = V::shift_in(V::load(h_load.data() + (seg_len - 1) * L), top(j));
+        vector_type v_f = V::shift_in(v_neg, top(j + 1) - open), v_col = v_zero;
+        for (int k = 0; k < seg_len; ++k) {
+            vector_type v_e = V::load(e.data() + k * L);
+            v_h = V::max(V::max(V::adds(v_h, V::load(p + k * L)), v_e), v_f);
+            if (local) v_h = V::max(v_h, v_zero);
+            V::store(h_store.data() + k * L, v_h);
+            v_col = V::max(v_col, v_h);
+            v_min = V::min(v_min, v_h);
+            vector_type v_ho = V::subs(v_h, v_open);
+            V::store(e.data() + k * L, V::max(V::subs(v_e, v_ext), v_ho));
+            v_f = V::max(V::subs(v_f, v_ext), v_ho);
+            v_h = V::load(h_load.data() + k * L);
+        }
+        // 帯をまたいで伝わる縦方向のギャップ(lazy-F)
+        v_f = V::shift_in(v_f, LO);
+        for (int k = 0; V::any_gt(v_f, V::subs(V::load(h_store.data() + k * L), v_open));) {
+            v_h = V::max(V::load(h_store.data() + k * L), v_f);
+            V::store(h_store.data() + k * L, v_h);
+            V::store(e.data() + k * L, V::max(V::load(e.data() + k * L), V::subs(v_h, v_open)));
+            v_col = V::max(v_col, v_h);
+            v_f = V::subs(v_f, v_ext);
+            if (++k == seg_len) k = 0, v_f = V::shift_in(v_f, LO);
+        }
+        v_max = V::max(v_max, v_col);
+        if (mode == AlignmentMode::LOCAL) {
+            V::store(buf.data(), v_col);
+            long long c = *max_element(buf.begin(), buf.end());
+            if (c > res.score) {
+                res = {c, -1, j, ""};
+                for (int i = 0; i < n && res.query_end < 0; ++i) if (lane(h_store, i) == c) res.query_end = i;
+            }
+        } else if (mode == AlignmentMode::SEMI_GLOBAL) {
+            long long c = lane(h_store, n - 1);
+            if (c > res.score) res = {c, n - 1, j, ""};
+        }
+        swap(h_load, h_store);
+    }
+    if (mode == AlignmentMode::GLOBAL) res = {lane(h_load, n - 1), n - 1, m - 1, ""};
+
+    V::store(buf.data(), v_max);
+    if (*max_element(buf.begin(), buf.end()) >= upper) return {};
+    V::store(buf.data(), v_min);
+    if (!local && *min_element(buf.begin(), buf.end()) <= lower) return {};
+    return res;
+}
+
+// Myers-Millerの線形メモリのアラインメント復元(大域, コストの最小化で記述)
+// tb, te := 先頭, 末尾でqueryの文字をギャップに対応させ始めるときの開始コスト(gap_openまたは0)
+void myers_miller(const vector<int>& a, int ab, int ae, const vector<int>& b, int bb, int be, long long tb, long long te, const AlignmentScoring& sc, string& ops) {
+    int m = ae - ab, n = be - bb;
+    long long g = sc.gap_open, h = sc.gap_extend;
+    auto gap = [&](long long k) -> long long {
+        return -sc.gap(k);
+    };
+    auto w = [&](int i, int j) -> long long {
+        return -sc.score(a.at(i), b.at(j));
+    };
+    if (n == 0) {
+        ops.append(m, 'I');
+        return;
+    }
+    if (m == 0) {
+        ops.append(n, 'D');
+        return;
+    }
+    if (m == 1) {
+        long long best = min(tb, te) + h + gap(n);
+        int bj = -1;
+        for (int j = 0; j < n; ++j) if (long long c = gap(j) + w(ab, bb + j) + gap(n - 1 - j); c < best) best = c, bj = j;
+        if (bj >= 0) ops.append(bj, 'D'), ops += 'M', ops.append(n - 1 - bj, 'D');
+        else if (tb <= te) ops += 'I', ops.append(n, 'D');
+        else ops.append(n, 'D'), ops += 'I';
+        return;
+    }
+    int mid = m / 2;
+    // cc.at(j) := a[ab, ab + mid)とb[bb, bb + j)の最小コスト, dd.at(j) := そのうちqueryの文字とギャップの対応で終わるもの
+    auto half = [&](int rows, long long tg, bool reversed, vector<long long>& cc, vector<long long>& dd) {
+        auto ai = [&](int i) { return reversed ? ae - 1 - i : ab + i; };
+        auto bj = [&](int j) { return reversed ? be - 1 - j : bb + j; };
+        cc.assign(n + 1, 0);
+        dd.assign(n + 1, 0);
+        long long t = g;
+        for (int j = 1; j <= n; ++j) t += h, cc.at(j) = t, dd.at(j) = t + g;
+        t = tg;
+        for (int i = 1; i <= rows; ++i) {
+            long long s = cc.at(0), c, e;
+            t += h;
+            c = cc.at(0) = t;
+            e = t + g;
+            for (int j = 1; j <= n; ++j) {
+                e = min(e, c + g) + h;
+                dd.at(j) = min(dd.at(j), cc.at(j) + g) + h;
+                c = min({dd.at(j), e, s + w(ai(i - 1), bj(j - 1))});
+                s = cc.at(j);
+                cc.at(j) = c;
+            }
+        }
+        dd.at(0) = cc.at(0);
+    };
+    vector<long long> cc, dd, rr, ss;
+    half(mid, tb, false, cc, dd);
+    half(m - mid, te, true, rr, ss);
+    long long best = cc.at(0) + rr.at(n);
+    int bj = 0;
+    bool joined = false;
+    for (int j = 0; j <= n; ++j) {
+        if (long long c = cc.at(j) + rr.at(n - j); c < best) best = c, bj = j, joined = false;
+        if (long long c = dd.at(j) + ss.at(n - j) - g; c < best) best = c, bj = j, joined = true;
+    }
+    if (!joined) {
+        myers_miller(a, ab, ab + mid, b, bb, bb + bj, tb, g, sc, ops);
+        myers_miller(a, ab + mid, ae, b, bb + bj, be, g, te, sc, ops);
+    } else {
+        myers_miller(a, ab, ab + mid - 1, b, bb, bb + bj, tb, 0, sc, ops);
+        ops += "II";
+        myers_miller(a, ab + mid + 1, ae, b, bb + bj, be, 0, te, sc, ops);
+    }
+}
+
+// queryを固定して多数のtargetとアラインメントをとる
+// スコア表は構築時に1度だけ作り, 8ビット(LOCALのみ), 16ビット, 32ビットのレーンで計算して値域を超えたら幅を広げて計算し直す
+struct AffineAligner {
+private:
+    vector<int> query_;
+    AlignmentScoring scoring_;
+    AlignmentMode mode_;
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    StripedProfile<AlignmentVector8> profile8_;
+#endif
+#if defined(__SSE2__)
+    StripedProfile<AlignmentVector16> profile16_;
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    StripedProfile<AlignmentVector32> profile32_;
+#endif
+    AlignmentResult align_score(const vector<int>& t) const {
+        if (!query_.empty() && !t.empty()) {
+#if defined(__AVX2__) || defined(__SSE4_1__)
+            if (mode_ == AlignmentMode::LOCAL) if (auto r = striped_align(profile8_, query_.size(), t, scoring_, mode_)) return r.value();
+#endif
+#if defined(__SSE2__)
+            if (auto r = striped_align(profile16_, query_.size(), t, scoring_, mode_)) return r.value();
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+            if (auto r = striped_align(profile32_, query_.size(), t, scoring_, mode_)) return r.value();
+#endif
+        }
+        return gotoh_align(query_, t, scoring_, mode_);
+    }
+    // 終端を固定した逆向きのアラインメントで, スコアがscoreに達した位置を求める
+    // queryの接頭辞を反転したものなので, スコア表はその都度作る
+    AlignmentResult reverse_score(const vector<int>& rq, const vector<int>& rt, long long score) const {
+#if defined(__SSE2__)
+        if (auto r = striped_align(StripedProfile<AlignmentVector16>(rq, scoring_, mode_), rq.size(), rt, scoring_, mode_, true, score)) return r.value();
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+        if (auto r = striped_align(StripedProfile<AlignmentVector32>(rq, scoring_, mode_), rq.size(), rt, scoring_, mode_, true, score)) return r.value();
+#endif
+        return gotoh_align(rq, rt, scoring_, mode_, true);
+    }
+public:
+    AffineAligner(const string& query, const AlignmentScoring& scoring, AlignmentMode mode) : query_(scoring.encode(query)), scoring_(scoring), mode_(mode) {
+#if defined(__AVX2__) || defined(__SSE4_1__)
+        if (mode_ == AlignmentMode::LOCAL) profile8_ = StripedProfile<AlignmentVector8>(query_, scoring_, mode_);
+#endif
+#if defined(__SSE2__)
+        profile16_ = StripedProfile<AlignmentVector16>(query_, scoring_, mode_);
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+        profile32_ = StripedProfile<AlignmentVector32>(query_, scoring_, mode_);
+#endif
+    }
+    // tracebackのときは終端から逆向きに始端を求め, その区間をMyers-Millerで復元する
+    AlignmentResult align(const string& target, bool traceback = false) const {
+        vector<int> t = scoring_.encode(target);
+        AlignmentResult res = align_score(t);
+        if (!traceback) return res;
+        int qb = 0, tb = 0;
+        if (mode_ != AlignmentMode::GLOBAL && res.query_end >= 0 && res.target_end >= 0) {
+            // 対応させる文字の組は高々query_end + 1個なので, targetの文字をギャップに対応させる個数は
+            // (組の個数 * 置換スコアの最大値 - スコア) / gap_extend 以下で, targetはその分だけ遡ればよい
+            long long sub_hi = 0, rows = res.query_end + 1;
+            for (const auto& i : scoring_.substitution) for (const auto& j : i) upd_max(sub_hi, j);
+            long long span = rows + max(0LL, rows * sub_hi - res.score) / scoring_.gap_extend;
+            int tl = max(0LL, res.target_end + 1 - span);
+            vector<int> rq(query_.rend() - res.query_end - 1, query_.rend()), rt(t.rend() - res.target_end - 1, t.rend() - tl);
+            AlignmentResult r = reverse_score(rq, rt, res.score);
+            qb = res.query_end - r.query_end, tb = res.target_end - r.target_end;
+        } else if (mode_ == AlignmentMode::SEMI_GLOBAL) {
+            tb = res.target_end + 1;
+        } else if (mode_ == AlignmentMode::LOCAL) {
+            return res;
+        }
+        string ops;
+        myers_miller(query_, qb, res.query_end + 1, t, tb, res.target_end + 1, scoring_.gap_open, scoring_.gap_open, scoring_, ops);
+        for (int i = 0, j = 0; i < static_cast<int>(ops.size()); i = j) {
+            while (j < static_cast<int>(ops.size()) && ops.at(j) == ops.at(i)) ++j;
+            res.cigar += to_string(j - i) + ops.at(i);
+        }
+        return res;
+    }
+};
+
 int main() {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
@@ -114,5 +589,16 @@ int main() {
     cout << lcs(s, t) << '\n';
     cout << lcs_s(s, t) << '\n';
     cout << levenshtein(s, t) << '\n';
+
+    string alphabet = s + t;
+    sort(alphabet.begin(), alphabet.end());
+    alphabet.erase(unique(alphabet.begin(), alphabet.end()), alphabet.end());
+    // 単位コストではlevenshteinと一致する
+    cout << -AffineAligner(s, AlignmentScoring(alphabet, 0, -1, 0, 1), AlignmentMode::GLOBAL).align(t).score << '\n';
+    AlignmentScoring scoring(alphabet, 2, -1, 2, 1);
+    for (auto mode : {AlignmentMode::GLOBAL, AlignmentMode::LOCAL, AlignmentMode::SEMI_GLOBAL}) {
+        auto r = AffineAligner(s, scoring, mode).align(t, true);
+        cout << r.score << ' ' << r.query_end << ' ' << r.target_end << ' ' << r.cigar << '\n';
+    }
     return 0;
 }
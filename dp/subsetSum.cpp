@@ -18,7 +18,14 @@
 #include <bitset>
 #include <limits>
 #include <vector>
+#include <optional>
 #include <algorithm>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <random>
+#include <iterator>
+#include <cstdint>
 
 using namespace std;
 
@@ -258,6 +265,463 @@ bool subset_sum2(number_type sum, const vector< pair<number_type, int> >& v) {
     return dp.at(sum) >= 0;
 }
 
+// 998244353を法とする数論変換
+// 要素数は2^23以下の2冪
+// 変換の内部ではモンゴメリ乗算を使い, 入出力の各値は通常の剰余で表す
+struct Ntt {
+    constexpr static uint32_t MOD = 998244353, ROOT = 3;
+    constexpr static int MAX_LOG = 23;
+    static uint32_t mul(uint32_t a, uint32_t b) noexcept {
+        return static_cast<uint64_t>(a) * b % MOD;
+    }
+    static uint32_t add(uint32_t a, uint32_t b) noexcept {
+        return a + b >= MOD ? a + b - MOD : a + b;
+    }
+    static uint32_t pow(uint32_t a, uint64_t e) noexcept {
+        uint32_t r = 1;
+        for (; e; e >>= 1, a = mul(a, a)) if (e & 1) r = mul(r, a);
+        return r;
+    }
+    static uint32_t inv(uint32_t a) noexcept {
+        return pow(a, MOD - 2);
+    }
+private:
+    // NEG_INV := -MOD^{-1} mod 2^32, R2 := 2^64 mod MOD
+    constexpr static uint32_t NEG_INV = [] {
+        uint32_t r = MOD;
+        for (int i = 0; i < 4; ++i) r *= 2 - MOD * r;
+        return -r;
+    }();
+    constexpr static uint32_t R2 = static_cast<uint32_t>((static_cast<unsigned __int128>(1) << 64) % MOD);
+    // x * 2^{-32} mod MOD を[0, 2 * MOD)で返す
+    static uint32_t reduce(uint64_t x) noexcept {
+        return (x + static_cast<uint64_t>(static_cast<uint32_t>(x) * NEG_INV) * MOD) >> 32;
+    }
+    static uint32_t mont_mul(uint32_t a, uint32_t b) noexcept {
+        return reduce(static_cast<uint64_t>(a) * b);
+    }
+public:
+    // 順変換は結果をビット反転順に並べたまま返し, 逆変換はビット反転順の入力を受け取る
+    // 並べ替えを省くため, 順変換と逆変換の間では要素ごとの演算しかできない
+    static void transform(vector<uint32_t>& a, bool inverse = false) {
+        int n = a.size();
+        // w[h + j] := 長さ2hの段のj番目の回転因子(モンゴメリ表現)
+        vector<uint32_t> w(max(2, n));
+        for (int h = 1; h < n; h <<= 1) {
+            uint32_t wl = pow(ROOT, (MOD - 1) / (h << 1));
+            if (inverse) wl = inv(wl);
+            uint32_t wm = mont_mul(wl, R2), t = mont_mul(1, R2);
+            for (int j = 0; j < h; ++j, t = mont_mul(t, wm)) w[h + j] = t >= MOD ? t - MOD : t;
+        }
+        // 各要素は[0, 2 * MOD)に保つ
+        const uint32_t mod2 = MOD * 2;
+        auto fold = [mod2](uint32_t x) {
+            return x >= mod2 ? x - mod2 : x;
+        };
+        for (auto&& i : a) i = mont_mul(i, R2);
+        if (!inverse) {
+            for (int h = n >> 1; h >= 1; h >>= 1) for (int i = 0; i < n; i += h << 1) for (int j = 0; j < h; ++j) {
+                uint32_t x = a[i + j], y = a[i + j + h];
+                a[i + j] = fold(x + y);
+                a[i + j + h] = mont_mul(x + mod2 - y, w[h + j]);
+            }
+        } else {
+            for (int h = 1; h < n; h <<= 1) for (int i = 0; i < n; i += h << 1) for (int j = 0; j < h; ++j) {
+                uint32_t x = a[i + j], y = mont_mul(a[i + j + h], w[h + j]);
+                a[i + j] = fold(x + y);
+                a[i + j + h] = fold(x + mod2 - y);
+            }
+        }
+        // scaleはモンゴメリ表現なので, 掛けて1で還元すると通常の表現に戻る
+        uint32_t scale = inverse ? mont_mul(inv(n), R2) : mont_mul(1, R2);
+        for (auto&& i : a) {
+            i = mont_mul(mont_mul(i, scale), 1);
+            if (i >= MOD) i -= MOD;
+        }
+    }
+};
+
+// 64ビット語のビット列dstに, srcをxだけ上位へずらしたものを論理和で重ねる
+// 更新するのはhi番目以下の語だけで, 上位の語から更新するので, dstとsrcが同じでもよい
+inline void shift_or(vector<uint64_t>& dst, const vector<uint64_t>& src, long long x, long long hi = numeric_limits<long long>::max()) {
+    long long q = x >> 6;
+    int r = x & 63;
+    long long w = min(hi, static_cast<long long>(dst.size()) - 1);
+    if (r == 0) {
+        for (; w >= q; --w) dst[w] |= src[w - q];
+        return;
+    }
+    // 4語ずつ読んでから書く. 書く語より下位の語を後で書くので, 同じ列でも読む値は元のまま
+    for (; w - 4 >= q; w -= 4) {
+        uint64_t a0 = src[w - q], a1 = src[w - q - 1], a2 = src[w - q - 2], a3 = src[w - q - 3], a4 = src[w - q - 4];
+        dst[w] |= (a0 << r) | (a1 >> (64 - r));
+        dst[w - 1] |= (a1 << r) | (a2 >> (64 - r));
+        dst[w - 2] |= (a2 << r) | (a3 >> (64 - r));
+        dst[w - 3] |= (a3 << r) | (a4 >> (64 - r));
+    }
+    for (; w > q; --w) dst[w] |= (src[w - q] << r) | (src[w - q - 1] >> (64 - r));
+    if (w == q) dst[w] |= src[0] << r;
+}
+
+// 64ビット語のビット列dstに, srcをxだけ下位へずらしたものを論理和で重ねる
+// 更新するのはlo番目以上の語だけで, 下位の語から更新するので, dstとsrcが同じでもよい
+inline void shift_or_down(vector<uint64_t>& dst, const vector<uint64_t>& src, long long x, long long lo = 0) {
+    long long words = dst.size(), q = x >> 6;
+    int r = x & 63;
+    long long w = lo;
+    if (r == 0) {
+        for (; w + q < words; ++w) dst[w] |= src[w + q];
+        return;
+    }
+    for (; w + q + 4 < words; w += 4) {
+        uint64_t a0 = src[w + q], a1 = src[w + q + 1], a2 = src[w + q + 2], a3 = src[w + q + 3], a4 = src[w + q + 4];
+        dst[w] |= (a0 >> r) | (a1 << (64 - r));
+        dst[w + 1] |= (a1 >> r) | (a2 << (64 - r));
+        dst[w + 2] |= (a2 >> r) | (a3 << (64 - r));
+        dst[w + 3] |= (a3 >> r) | (a4 << (64 - r));
+    }
+    for (; w + q + 1 < words; ++w) dst[w] |= (src[w + q] >> r) | (src[w + q + 1] << (64 - r));
+    if (w + q < words) dst[w] |= src[w + q] >> r;
+}
+
+// 和集合 A+B = {a+b | a∈A, b∈B} のうちsum以下のもの
+// A, Bは昇順で重複なし, U := min(max(A) + max(B), sum)
+// 次の方法から見積もりが最も小さいものを選ぶ
+// ・ビット列のずらし: O(min(|A|, |B|) * U / 64)
+// ・NTT: O(U * log(U)), max(A) + max(B) < 2^23のとき
+// ・値をランダムな素数pで割った商と余りに分け, 余りの添字でNTTをとる疎な和集合: 期待O(|A+B| * log(|A+B|))
+//   各添字の組の個数, 商の和, 商の2乗の和から, 添字に落ちた和が1種類だけのものを取り出す
+//   取り出した和の組の個数の総和が|A| * |B|になるまでpを替えて繰り返す
+// ・ヒープによる併合: O(|A| * |B| * log(|A|)), U≥2^31でビット列もNTTも使えないときだけ
+// deterministicのときは疎な和集合を使わない
+template<typename number_type>
+vector<number_type> sumset(const vector<number_type>& a, const vector<number_type>& b, number_type sum, bool deterministic = false) {
+    constexpr long long BITSET_LIMIT = 1LL << 31;
+    if (a.empty() || b.empty()) return {};
+    // 最大公約数で割っておくと値の範囲が狭まる
+    number_type g = 0;
+    for (const auto& i : a) g = gcd(g, i);
+    for (const auto& i : b) g = gcd(g, i);
+    if (g > 1) {
+        vector<number_type> da(a.size()), db(b.size());
+        for (int i = 0; i < static_cast<int>(a.size()); ++i) da[i] = a[i] / g;
+        for (int i = 0; i < static_cast<int>(b.size()); ++i) db[i] = b[i] / g;
+        vector<number_type> res = sumset(da, db, static_cast<number_type>(sum / g), deterministic);
+        for (auto&& i : res) i *= g;
+        return res;
+    }
+    long long sa = a.size(), sb = b.size(), u = static_cast<long long>(a.back()) + b.back(), cap = min(u, static_cast<long long>(sum));
+    auto lg2 = [](long long x) {
+        int r = 1;
+        while ((1LL << r) < x) ++r;
+        return r;
+    };
+    // 見積もりは剰余乗算1回を4, 語の論理演算1回を1, ヒープ操作1回を16 * log程度として数える
+    constexpr double INF = numeric_limits<double>::infinity();
+    double pairs = static_cast<double>(sa) * sb;
+    double bitset_cost = cap < BITSET_LIMIT ? static_cast<double>(min(sa, sb)) * (cap / 64 + 1) : INF;
+    int lg = lg2(u + 1);
+    double ntt_cost = lg <= Ntt::MAX_LOG ? 3.0 * (1LL << lg) * lg * 4 : INF;
+    double heap_cost = bitset_cost < INF || ntt_cost < INF ? INF : pairs * lg2(sa + 1) * 16;
+    double best = min({heap_cost, bitset_cost, ntt_cost});
+    vector<number_type> res;
+
+    // 疎な和集合: 見積もりの下限が他より小さいときだけ試し, 費用がbestを超えそうなら打ち切る
+    auto hashed = [&]() -> bool {
+        static mt19937_64 rng(20201019);
+        auto is_prime = [](long long p) {
+            if (p < 2) return false;
+            for (long long d = 2; d * d <= p; ++d) if (p % d == 0) return false;
+            return true;
+        };
+        const uint32_t pairs_mod = static_cast<uint64_t>(sa) * sb % Ntt::MOD;
+        // found := 取り出した(和, その和になる組の個数)
+        vector< pair<long long, uint32_t> > found;
+        double spent = 0;
+        for (long long k = max(sa, sb); ; k = min(k << 1, 1LL << (Ntt::MAX_LOG - 3))) {
+            int len_log = lg2(k << 3);
+            long long len = 1LL << len_log;
+            double cost = 9.0 * len * len_log * 4 + (sa + sb) * 4;
+            if (spent + cost > best) return false;
+            spent += cost;
+            long long p;
+            do p = (k << 1) + static_cast<long long>(rng() % (k << 1)); while (!is_prime(p));
+            vector< vector<uint32_t> > f(6, vector<uint32_t>(len, 0));
+            auto put = [&](const vector<number_type>& s, int o) {
+                for (const auto& x : s) {
+                    uint32_t hi = static_cast<uint64_t>(x / p) % Ntt::MOD;
+                    long long lo = x % p;
+                    f[o][lo] = Ntt::add(f[o][lo], 1);
+                    f[o + 1][lo] = Ntt::add(f[o + 1][lo], hi);
+                    f[o + 2][lo] = Ntt::add(f[o + 2][lo], Ntt::mul(hi, hi));
+                }
+            };
+            put(a, 0);
+            put(b, 3);
+            for (auto&& i : f) Ntt::transform(i);
+            // c: 組の個数, s1: 商の和, s2: 商の2乗の和
+            vector<uint32_t>& c = f[0], & s1 = f[1], & s2 = f[2];
+            for (long long i = 0; i < len; ++i) {
+                uint32_t a0 = f[0][i], a1 = f[1][i], a2 = f[2][i], b0 = f[3][i], b1 = f[4][i], b2 = f[5][i];
+                c[i] = Ntt::mul(a0, b0);
+                s1[i] = Ntt::add(Ntt::mul(a1, b0), Ntt::mul(a0, b1));
+                s2[i] = Ntt::add(Ntt::add(Ntt::mul(a2, b0), Ntt::mul(a0, b2)), Ntt::mul(2, Ntt::mul(a1, b1)));
+            }
+            for (int i = 0; i < 3; ++i) Ntt::transform(f[i], true);
+            // 添字iとi + pには余りがiの和がまとめて落ちるので, 繰り上がりの分だけ商をずらして1つにする
+            vector< pair<long long, uint32_t> > got;
+            for (long long i = 0; i < p; ++i) {
+                uint32_t cc = Ntt::add(c[i], c[i + p]), ss1 = Ntt::add(Ntt::add(s1[i], s1[i + p]), c[i + p]);
+                uint32_t ss2 = Ntt::add(Ntt::add(s2[i], s2[i + p]), Ntt::add(Ntt::mul(2, s1[i + p]), c[i + p]));
+                if (!cc || Ntt::mul(cc, ss2) != Ntt::mul(ss1, ss1)) continue;
+                // 落ちた和が1種類ならば, その商はs1 / c
+                long long h = Ntt::mul(ss1, Ntt::inv(cc));
+                if (h > u / p) continue;
+                if (long long s = h * p + i; s <= u) got.emplace_back(s, cc);
+            }
+            sort(got.begin(), got.end());
+            vector< pair<long long, uint32_t> > merged;
+            merged.reserve(found.size() + got.size());
+            merge(found.begin(), found.end(), got.begin(), got.end(), back_inserter(merged));
+            merged.erase(unique(merged.begin(), merged.end(), [](const auto& x, const auto& y) {
+                return x.first == y.first;
+            }), merged.end());
+            found.swap(merged);
+            uint32_t total = 0;
+            for (const auto& i : found) total = Ntt::add(total, i.second);
+            if (total == pairs_mod) break;
+        }
+        for (const auto& i : found) if (i.first <= cap) res.push_back(i.first);
+        return true;
+    };
+
+    int hash_log = lg2(max(sa, sb) << 3);
+    if (!deterministic && 9.0 * (1LL << hash_log) * hash_log * 4 < best && hash_log <= Ntt::MAX_LOG && hashed()) return res;
+    if (best == ntt_cost) {
+        // 各係数は高々min(|A|, |B|) < MODなので, 0でなければその和は実現可能
+        vector<uint32_t> fa(1 << lg, 0), fb(1 << lg, 0);
+        for (const auto& i : a) fa[i] = 1;
+        for (const auto& i : b) fb[i] = 1;
+        Ntt::transform(fa);
+        Ntt::transform(fb);
+        for (int i = 0; i < (1 << lg); ++i) fa[i] = Ntt::mul(fa[i], fb[i]);
+        Ntt::transform(fa, true);
+        for (long long i = 0; i <= cap; ++i) if (fa[i]) res.push_back(i);
+    } else if (best == bitset_cost) {
+        const auto& small = sa <= sb ? a : b;
+        const auto& large = sa <= sb ? b : a;
+        vector<uint64_t> src(cap / 64 + 1, 0), dst(cap / 64 + 1, 0);
+        for (const auto& i : large) if (i <= cap) src[i >> 6] |= 1ULL << (i & 63);
+        for (const auto& i : small) {
+            if (i > cap) break;
+            shift_or(dst, src, i);
+        }
+        for (long long w = 0; w <= cap / 64; ++w) for (uint64_t t = dst[w]; t; t &= t - 1) {
+            long long x = (w << 6) + __builtin_ctzll(t);
+            if (x > cap) break;
+            res.push_back(x);
+        }
+    } else {
+        // (a_i + b_j, i, j)の最小ヒープで昇順に取り出す
+        using entry = tuple<long long, int, int>;
+        priority_queue< entry, vector<entry>, greater<entry> > pq;
+        for (int i = 0; i < sa && a[i] + b[0] <= cap; ++i) pq.emplace(static_cast<long long>(a[i]) + b[0], i, 0);
+        while (!pq.empty()) {
+            auto [s, i, j] = pq.top();
+            pq.pop();
+            if (res.empty() || res.back() != s) res.push_back(s);
+            if (j + 1 < sb && static_cast<long long>(a[i]) + b[j + 1] <= cap) pq.emplace(static_cast<long long>(a[i]) + b[j + 1], i, j + 1);
+        }
+    }
+    return res;
+}
+
+// ビット列による部分和問題
+// 品物を半分に分け, 前半の品物で作れる和の集合と, sumから後半の品物を引いて作れる値の集合の共通部分から
+// 前半に割り当てる和を1つ決め, 両半分で同じことを繰り返す(Hirschbergの分割)
+// 前半は作れる和の上界, 後半は下界より外側の語を更新しない
+// O(n * sum / 64) (判定だけの場合の2倍程度), メモリO(sum / 64)
+template<typename number_type>
+optional< vector<int> > bitset_subset_sum(number_type sum, const vector<number_type>& v) {
+    if (sum < 0) return {};
+    vector<int> idx;
+    for (int i = 0; i < static_cast<int>(v.size()); ++i) if (v.at(i) <= sum) idx.push_back(i);
+    vector<int> res;
+    // idx[l, r)の品物からちょうどsになるように選べれば, resに加えてtrueを返す
+    auto solve = [&](auto&& self, int l, int r, long long s) -> bool {
+        if (s == 0) return true;
+        if (r - l <= 1) {
+            if (r == l || v[idx[l]] != s) return false;
+            res.push_back(idx[l]);
+            return true;
+        }
+        // 値の順に交互に前半と後半へ振り分けて両側の総和を釣り合わせ, それぞれ小さい順に処理して和の範囲を狭く保つ
+        vector<int> sorted(idx.begin() + l, idx.begin() + r);
+        sort(sorted.begin(), sorted.end(), [&](int i, int j) {
+            return v[i] < v[j];
+        });
+        int m = (l + r + 1) >> 1;
+        for (int i = 0; i < r - l; ++i) idx[(i & 1 ? m : l) + (i >> 1)] = sorted[i];
+        long long lo = s, hi = 0, x = -1;
+        {
+            vector<uint64_t> fw((s >> 6) + 1, 0), bw((s >> 6) + 1, 0);
+            fw[0] = 1;
+            bw[s >> 6] = 1ULL << (s & 63);
+            for (int i = l; i < m; ++i) if (v[idx[i]] <= s) {
+                hi = min(s, hi + v[idx[i]]);
+                shift_or(fw, fw, v[idx[i]], hi >> 6);
+            }
+            for (int i = m; i < r; ++i) if (v[idx[i]] <= s) {
+                lo = max(0LL, lo - v[idx[i]]);
+                shift_or_down(bw, bw, v[idx[i]], lo >> 6);
+            }
+            for (long long w = lo >> 6; w <= hi >> 6 && x < 0; ++w) if (uint64_t t = fw[w] & bw[w]) x = (w << 6) + __builtin_ctzll(t);
+        }
+        if (x < 0) return false;
+        return self(self, l, m, x) && self(self, m, r, s - x);
+    };
+    if (!solve(solve, 0, idx.size(), sum)) return {};
+    sort(res.begin(), res.end());
+    return res;
+}
+
+// コア問題による部分和問題
+// 値の小さいk個の品物を核として残し, 残りの品物を大きい順に sum - (核の総和) / 2 を超えない範囲で貪欲に選んでから,
+// 残った差を核の品物だけでbitset_subset_sumにより作る. 作れなければkを倍にして試し直す
+// 品物が多く実現可能な和が密なときに速いが, nulloptは実現不可能を意味しない
+template<typename number_type>
+optional< vector<int> > core_subset_sum(number_type sum, const vector<number_type>& v) {
+    constexpr long long CORE_WORDS = 1LL << 26;
+    vector<int> ord;
+    for (int i = 0; i < static_cast<int>(v.size()); ++i) if (v.at(i) <= sum) ord.push_back(i);
+    sort(ord.begin(), ord.end(), [&](int i, int j) {
+        return v.at(i) < v.at(j);
+    });
+    int n = ord.size();
+    for (int k = 32; k < n; k <<= 1) {
+        long long core = 0;
+        for (int i = 0; i < k; ++i) core += v.at(ord.at(i));
+        if (static_cast<double>(k) * (core / 64 + 1) > CORE_WORDS) break;
+        long long target = sum - core / 2, cur = 0;
+        vector<int> res;
+        for (int i = n - 1; i >= k; --i) if (cur + v.at(ord.at(i)) <= target) {
+            cur += v.at(ord.at(i));
+            res.push_back(ord.at(i));
+        }
+        if (sum - cur > core) continue;
+        vector<number_type> cv(k);
+        for (int i = 0; i < k; ++i) cv.at(i) = v.at(ord.at(i));
+        if (auto r = bitset_subset_sum(static_cast<number_type>(sum - cur), cv)) {
+            for (const auto& i : *r) res.push_back(ord.at(i));
+            sort(res.begin(), res.end());
+            return res;
+        }
+    }
+    return {};
+}
+
+// 部分和問題
+// 実現可能ならば和がsumとなる品物の添字の集合を昇順で返す. 次の順に調べる
+// ・sumより大きい品物を除き, 残りの値の最大公約数で割る. 総和がsumに満たなければ実現不可能
+// ・総和の半分を超えるsumは, 総和 - sumを作る補集合の問題に置き換える
+// ・core_subset_sumで見つかればそれを返す
+// ・bitset_subset_sumと和集合による分割統治のうち見積もりの小さい方で解く
+//   分割統治は品物を半分ずつに分け, 各区間で実現可能なsum以下の和の集合をsumsetで合成する
+//   各区間の和の個数は min(2^(品物の個数), 区間の総和 + 1) で見積もるので, 分割統治を選ぶのは和が疎なときだけになる
+// 疎な和集合は確率的なので, 復元した品物の和がsumにならなければ疎な和集合を使わずに解き直す
+// ・1≤a[i]
+template<typename number_type>
+optional< vector<int> > sparse_subset_sum(number_type sum, const vector<number_type>& v) {
+    // ビット列1本あたりの語数の上限(512MiB)
+    constexpr long long BITSET_MEMORY = 1LL << 26;
+    if (sum < 0) return {};
+    if (sum == 0) return vector<int>();
+    number_type g = 0;
+    long long total = 0;
+    for (const auto& i : v) if (i <= sum) g = gcd(g, i), total += i;
+    if (g == 0 || sum % g || total < sum) return {};
+    // items.at(i) := w.at(i)の元の添字
+    vector<int> items;
+    vector<number_type> w;
+    for (int i = 0; i < static_cast<int>(v.size()); ++i) if (v.at(i) <= sum) {
+        items.push_back(i);
+        w.push_back(v.at(i) / g);
+    }
+    sum /= g;
+    total /= g;
+    int n = w.size();
+    auto lift = [&](vector<int> r) {
+        for (auto&& i : r) i = items.at(i);
+        return r;
+    };
+    if (sum > total - sum) {
+        auto r = sparse_subset_sum(static_cast<number_type>(total - sum), w);
+        if (!r) return {};
+        vector<int> res;
+        for (int i = 0, j = 0; i < n; ++i) {
+            if (j < static_cast<int>(r->size()) && r->at(j) == i) ++j;
+            else res.push_back(items.at(i));
+        }
+        return res;
+    }
+    if (auto r = core_subset_sum(sum, w)) return lift(*r);
+
+    // 見積もりの単位はsumsetと同じで, 疎な和集合の合成は和の個数eに対して 288 * e * log(8 * e) 程度
+    double bitset_cost = 2.0 * n * (sum / 64 + 1), sparse_cost = 0;
+    auto estimate = [&](auto&& self, int l, int r) -> pair<double, long long> {
+        if (r - l == 1) return {2, w.at(l)};
+        int m = (l + r) >> 1;
+        auto [el, tl] = self(self, l, m);
+        auto [er, tr] = self(self, m, r);
+        double e = min(el * er, static_cast<double>(min(tl + tr, static_cast<long long>(sum))) + 1);
+        sparse_cost += 288 * e * log2(8 * e);
+        return {e, tl + tr};
+    };
+    estimate(estimate, 0, n);
+    if (sum / 64 + 1 <= BITSET_MEMORY && bitset_cost <= sparse_cost) {
+        if (auto r = bitset_subset_sum(sum, w)) return lift(*r);
+        return {};
+    }
+
+    for (bool deterministic : {false, true}) {
+        // sets.at(k) := 節点kが表す区間の品物で実現可能なsum以下の和の集合
+        vector< vector<number_type> > sets(n << 2);
+        auto build = [&](auto&& self, int k, int l, int r) -> void {
+            if (r - l == 1) {
+                sets.at(k) = {0, w.at(l)};
+                return;
+            }
+            int m = (l + r) >> 1;
+            self(self, k << 1, l, m);
+            self(self, k << 1 | 1, m, r);
+            sets.at(k) = sumset(sets.at(k << 1), sets.at(k << 1 | 1), sum, deterministic);
+        };
+        build(build, 1, 0, n);
+        if (!binary_search(sets.at(1).begin(), sets.at(1).end(), sum)) return {};
+        vector<int> res;
+        auto restore = [&](auto&& self, int k, int l, int r, number_type s) -> bool {
+            if (r - l == 1) {
+                if (s != 0) res.push_back(l);
+                return s == 0 || s == w.at(l);
+            }
+            int m = (l + r) >> 1;
+            const auto& left = sets.at(k << 1);
+            const auto& right = sets.at(k << 1 | 1);
+            for (const auto& i : left) {
+                if (i > s) break;
+                if (!binary_search(right.begin(), right.end(), s - i)) continue;
+                return self(self, k << 1, l, m, i) && self(self, k << 1 | 1, m, r, s - i);
+            }
+            return false;
+        };
+        long long got = 0;
+        if (restore(restore, 1, 0, n, sum)) for (const auto& i : res) got += w.at(i);
+        // 疎な和集合が異なる和を取り違えていると, 復元した品物の和がsumにならない
+        if (got == sum) return lift(res);
+    }
+    return {};
+}
+
 int main() {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
@@ -269,6 +733,20 @@ int main() {
     for (auto&& i : v) cin >> i;
     cout << (subset_sum1<int, MAX>(a, v) ? "Yes" : "No") << '\n';
     cout << (subset_sum2(a, v) ? "Yes" : "No") << '\n';
+    auto witness = sparse_subset_sum(a, v);
+    cout << (witness.has_value() ? "Yes" : "No") << '\n';
+    // bitsetによる結果と一致し, 返した添字が重複なく和がaになることを確かめる
+    bool consistent = a > MAX || witness.has_value() == subset_sum1<int, MAX>(a, v);
+    if (witness.has_value()) {
+        long long total = 0;
+        for (int i = 0; i < static_cast<int>(witness->size()); ++i) {
+            int j = witness->at(i);
+            consistent &= 0 <= j && j < n && (i == 0 || witness->at(i - 1) < j);
+            if (0 <= j && j < n) total += v.at(j);
+        }
+        consistent &= total == a;
+    }
+    cout << (consistent ? "Yes" : "No") << '\n';
     cout << count_subset_sum<MOD>(a, v) << '\n';
     cout << minimum_subset_sum(a, v) << '\n';
     cout << (capped_subset_sum1<int, MAX>(a, v, k) ? "Yes" : "No") << '\n';